@@ -0,0 +1,92 @@
+#pragma once
+
+#include "time_series.h"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Live per-CPU utilization and frequency, kept as fixed-length history.
+// On Linux the data comes from /proc/stat and cpufreq sysfs; a synthetic
+// source can stand in for arbitrarily large hosts.
+class CPUMonitor {
+public:
+    struct CoreTopology {
+        int package_id = 0;
+        int core_id = 0;
+    };
+
+    CPUMonitor(size_t history_samples, std::chrono::milliseconds interval);
+    ~CPUMonitor();
+    
+    CPUMonitor(const CPUMonitor&) = delete;
+    CPUMonitor& operator=(const CPUMonitor&) = delete;
+    
+    bool initialize();
+    void initializeSynthetic(uint32_t cpu_count);
+    
+    // Take any samples that are due; returns the number taken
+    uint32_t update();
+    void sample();
+    
+    // Synthetic source only: fill the whole history up front
+    void prefill();
+    
+    bool isAvailable() const { return cpu_count_ > 0; }
+    bool isSynthetic() const { return synthetic_; }
+    uint32_t cpuCount() const { return cpu_count_; }
+    uint32_t packageCount() const { return package_count_; }
+    double intervalSeconds() const { return interval_.count() / 1000.0; }
+    
+    uint32_t cpuId(uint32_t index) const { return cpu_ids_[index]; }
+    const CoreTopology& topology(uint32_t index) const { return topology_[index]; }
+    const RingBuffer& utilization(uint32_t index) const { return utilization_[index]; }
+    float frequencyMHz(uint32_t index) const { return frequency_mhz_[index]; }
+    
+    const RingBuffer& averageUtilization() const { return avg_utilization_; }
+    const RingBuffer& averageFrequency() const { return avg_frequency_; }
+
+private:
+    struct CpuTimes {
+        uint64_t busy = 0;
+        uint64_t total = 0;
+    };
+
+    size_t history_samples_;
+    std::chrono::milliseconds interval_;
+    std::chrono::steady_clock::time_point next_sample_;
+    
+    bool synthetic_ = false;
+    uint32_t cpu_count_ = 0;
+    uint32_t package_count_ = 0;
+    
+    std::vector<uint32_t> cpu_ids_;
+    std::vector<int> index_by_id_;
+    std::vector<CoreTopology> topology_;
+    std::vector<RingBuffer> utilization_;
+    std::vector<float> frequency_mhz_;
+    RingBuffer avg_utilization_;
+    RingBuffer avg_frequency_;
+    
+    // Live source state, opened once so sampling does not allocate
+    int stat_fd_ = -1;
+    std::vector<int> freq_fds_;
+    std::vector<char> stat_buffer_;
+    std::vector<CpuTimes> prev_times_;
+    std::vector<float> current_util_;
+    
+    // Synthetic source state
+    uint64_t rng_state_ = 0x9E3779B97F4A7C15ull;
+    uint64_t synthetic_tick_ = 0;
+    float wave_step_cos_ = 1.0f;
+    float wave_step_sin_ = 0.0f;
+    std::vector<float> wave_cos_;
+    std::vector<float> wave_sin_;
+    
+    void allocateHistory();
+    void closeFiles();
+    void sampleLive();
+    void sampleSynthetic();
+    float nextSyntheticUtilization(uint32_t index, bool renormalize);
+    void pushSample();
+    float nextRandom();
+};
@@ -1,14 +1,22 @@
 #pragma once
 
 #include "cpu_info.h"
+#include "cpu_monitor.h"
 #include <memory>
+#include <vector>
 
 struct SDL_Window;
 typedef void *SDL_GLContext;
 
 class GUI {
 public:
+    struct Options {
+        uint32_t synthetic_cpus = 0;    // 0 = live data from this host
+        uint32_t benchmark_frames = 0;  // 0 = run until the window is closed
+    };
+
     GUI();
+    explicit GUI(const Options& options);
     ~GUI();
     
     bool initialize();
@@ -16,12 +24,40 @@ public:
     void shutdown();
 
 private:
+    enum class PlotMode { MinMax, LTTB };
+
+    Options options_;
     SDL_Window* window_ = nullptr;
     SDL_GLContext gl_context_ = nullptr;
     std::unique_ptr<CPUInfo> cpu_info_;
+    std::unique_ptr<CPUMonitor> monitor_;
+    
+    // Monitor view state
+    int selected_cpu_ = 0;
+    int history_seconds_ = 60;
+    PlotMode plot_mode_ = PlotMode::MinMax;
+    std::vector<uint32_t> heatmap_order_;
+    
+    // Scratch buffers reused every frame
+    std::vector<float> plot_min_;
+    std::vector<float> plot_max_;
+    std::vector<float> plot_x_;
+    std::vector<float> plot_y_;
+    
+    RingBuffer ui_times_ms_;
+    RingBuffer frame_times_ms_;
+    uint64_t frame_count_ = 0;
     
     void render();
     void renderProcessorInfo();
     void renderFeatures();
     void renderCacheInfo();
+    void renderPerCPU();
+    void renderTopologyHeatmap();
+    void renderHistory();
+    void renderFrameStats();
+    void renderTimeSeries(const char* id, const RingBuffer& series, size_t window,
+                          float v_min, float v_max, float height);
+    void printBenchmarkReport() const;
+    static void printTimingSummary(const char* label, const RingBuffer& samples);
 };
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "cpu_info.h"
+#include "cpu_monitor.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Headless daemon that samples per-CPU telemetry on a fixed schedule and
+// serves it in Prometheus text format over HTTP on a local TCP port or a
+// Unix socket. All buffers are sized at startup; neither sampling nor
+// serving a scrape allocates. Linux only.
+class MetricsExporter {
+public:
+    struct Options {
+        std::string listen = "127.0.0.1:9101";  // "host:port" or "unix:/path"
+        uint32_t interval_ms = 1000;
+    };
+
+    explicit MetricsExporter(const Options& options);
+    ~MetricsExporter();
+    
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+    
+    bool initialize();
+    
+    // Serve until SIGINT or SIGTERM
+    void run();
+    void shutdown();
+
+private:
+    // Per-CPU cycles and instructions from perf events, when permitted.
+    // Totals accumulate multiplex-scaled deltas of the raw readings.
+    struct HardwareCounters {
+        int group_fd = -1;
+        int instructions_fd = -1;
+        uint64_t cycles = 0;
+        uint64_t instructions = 0;
+        uint64_t last_cycles = 0;
+        uint64_t last_instructions = 0;
+        uint64_t last_enabled = 0;
+        uint64_t last_running = 0;
+    };
+
+    // A connection in progress. Clients are non-blocking and advanced from
+    // the same poll() loop that drives sampling, each with its own deadline.
+    struct Client {
+        enum class State { Free, Reading, Writing };
+        
+        State state = State::Free;
+        int fd = -1;
+        std::chrono::steady_clock::time_point deadline;
+        char request[1024];
+        size_t request_length = 0;
+        char header[256];
+        size_t header_length = 0;
+        const char* body = nullptr;
+        size_t body_length = 0;
+        size_t sent = 0;
+        bool writing_metrics = false;
+    };
+
+    Options options_;
+    std::unique_ptr<CPUInfo> cpu_info_;
+    std::unique_ptr<CPUMonitor> monitor_;
+    std::vector<HardwareCounters> counters_;
+    bool counters_available_ = false;
+    
+    int listen_fd_ = -1;
+    std::string unix_path_;
+    
+    // Metrics that never change, rendered once at startup
+    std::string static_metrics_;
+    std::vector<char> body_;
+    size_t body_length_ = 0;
+    
+    // Fixed client slots, allocated at startup
+    std::vector<Client> clients_;
+    uint32_t metrics_writers_ = 0;
+    
+    std::chrono::steady_clock::time_point start_time_;
+    double start_cpu_seconds_ = 0.0;
+    double last_sample_seconds_ = 0.0;
+    uint64_t samples_ = 0;
+    uint64_t scrapes_ = 0;
+    
+    bool openListener();
+    void openHardwareCounters();
+    void sample();
+    void acceptClients();
+    void readRequest(Client& client);
+    void startResponse(Client& client);
+    void writeResponse(Client& client);
+    void closeClient(Client& client);
+    size_t renderMetrics();
+    void renderStaticMetrics();
+};
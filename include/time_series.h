@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Fixed-capacity ring buffer of samples. Storage is allocated once in
+// reset(), so push() never allocates.
+class RingBuffer {
+public:
+    RingBuffer() = default;
+    explicit RingBuffer(size_t capacity) { reset(capacity); }
+    
+    void reset(size_t capacity);
+    void clear() { head_ = 0; size_ = 0; }
+    
+    void push(float value) {
+        data_[head_] = value;
+        head_ = (head_ + 1 == data_.size()) ? 0 : head_ + 1;
+        if (size_ < data_.size()) size_++;
+    }
+    
+    size_t size() const { return size_; }
+    size_t capacity() const { return data_.size(); }
+    bool empty() const { return size_ == 0; }
+    
+    // Index 0 is the oldest sample still held
+    float operator[](size_t i) const {
+        size_t idx = head_ + data_.size() - size_ + i;
+        if (idx >= data_.size()) idx -= data_.size();
+        return data_[idx];
+    }
+    
+    float latest() const { return size_ ? (*this)[size_ - 1] : 0.0f; }
+    
+    // Logical range [first, first + count) as at most two contiguous spans
+    void spans(size_t first, size_t count,
+               const float*& a, size_t& a_len, const float*& b, size_t& b_len) const;
+
+private:
+    std::vector<float> data_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+};
+
+// Reduce a window of a ring buffer to roughly one point per pixel column.
+// Output vectors are reused between calls so steady-state rendering does
+// not allocate.
+namespace Downsample {
+    // One (min, max) pair per bucket; preserves spikes, suited to envelopes
+    void minMax(const RingBuffer& src, size_t first, size_t count, size_t buckets,
+                std::vector<float>& out_min, std::vector<float>& out_max);
+    
+    // Largest-Triangle-Three-Buckets; keeps the visual shape of a line with
+    // `threshold` points. out_x holds sample indices relative to `first`.
+    void lttb(const RingBuffer& src, size_t first, size_t count, size_t threshold,
+              std::vector<float>& out_x, std::vector<float>& out_y);
+}
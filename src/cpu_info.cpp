@@ -177,7 +177,7 @@ void CPUInfo::detectCacheInfo() {
         uint32_t cache_size_bytes = ways * partitions * line_size * sets;
         uint32_t cache_size_kb = cache_size_bytes / 1024;
         
-        if (cache_line_size == 0) {
+        if (cache_info_.cache_line_size == 0) {
             cache_info_.cache_line_size = line_size;
         }
         
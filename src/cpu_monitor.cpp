@@ -0,0 +1,363 @@
+#include "cpu_monitor.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+// Parse an unsigned decimal at p, advancing past it and any leading spaces
+uint64_t parseU64(const char*& p, const char* end) {
+    while (p < end && *p == ' ') p++;
+    uint64_t value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (uint64_t)(*p - '0');
+        p++;
+    }
+    return value;
+}
+
+int readSysfsInt(const std::string& path, int fallback) {
+    std::ifstream file(path);
+    int value;
+    if (file >> value) {
+        return value;
+    }
+    return fallback;
+}
+#endif
+
+} // namespace
+
+CPUMonitor::CPUMonitor(size_t history_samples, std::chrono::milliseconds interval)
+    : history_samples_(history_samples), interval_(interval) {}
+
+CPUMonitor::~CPUMonitor() {
+    closeFiles();
+}
+
+void CPUMonitor::closeFiles() {
+#ifdef __linux__
+    if (stat_fd_ >= 0) {
+        close(stat_fd_);
+        stat_fd_ = -1;
+    }
+    for (int fd : freq_fds_) {
+        if (fd >= 0) close(fd);
+    }
+#endif
+    freq_fds_.clear();
+}
+
+void CPUMonitor::allocateHistory() {
+    utilization_.resize(cpu_count_);
+    for (auto& history : utilization_) {
+        history.reset(history_samples_);
+    }
+    avg_utilization_.reset(history_samples_);
+    avg_frequency_.reset(history_samples_);
+    
+    frequency_mhz_.assign(cpu_count_, 0.0f);
+    current_util_.assign(cpu_count_, 0.0f);
+    
+    int max_package = 0;
+    for (const auto& topo : topology_) {
+        max_package = std::max(max_package, topo.package_id);
+    }
+    package_count_ = cpu_count_ ? (uint32_t)max_package + 1 : 0;
+    
+    next_sample_ = std::chrono::steady_clock::now();
+}
+
+bool CPUMonitor::initialize() {
+#ifdef __linux__
+    closeFiles();
+    synthetic_ = false;
+    
+    stat_fd_ = open("/proc/stat", O_RDONLY | O_CLOEXEC);
+    if (stat_fd_ < 0) {
+        return false;
+    }
+    
+    // Size the read buffer from one full read, with headroom
+    std::vector<char> probe(64 * 1024);
+    size_t length = 0;
+    for (;;) {
+        ssize_t n = pread(stat_fd_, probe.data() + length, probe.size() - length, (off_t)length);
+        if (n <= 0) break;
+        length += (size_t)n;
+        if (length == probe.size()) probe.resize(probe.size() * 2);
+    }
+    stat_buffer_.assign(length * 2 + 4096, 0);
+    
+    // Enumerate "cpuN" lines; offline CPUs are absent from /proc/stat
+    cpu_ids_.clear();
+    const char* p = probe.data();
+    const char* end = p + length;
+    while (p < end) {
+        const char* eol = (const char*)memchr(p, '\n', (size_t)(end - p));
+        if (!eol) eol = end;
+        if (eol - p > 3 && std::memcmp(p, "cpu", 3) == 0 && p[3] >= '0' && p[3] <= '9') {
+            const char* q = p + 3;
+            cpu_ids_.push_back((uint32_t)parseU64(q, eol));
+        }
+        p = eol + 1;
+    }
+    
+    cpu_count_ = (uint32_t)cpu_ids_.size();
+    if (cpu_count_ == 0) {
+        closeFiles();
+        return false;
+    }
+    
+    uint32_t max_id = *std::max_element(cpu_ids_.begin(), cpu_ids_.end());
+    index_by_id_.assign(max_id + 1, -1);
+    topology_.assign(cpu_count_, CoreTopology{});
+    freq_fds_.assign(cpu_count_, -1);
+    
+    for (uint32_t i = 0; i < cpu_count_; i++) {
+        index_by_id_[cpu_ids_[i]] = (int)i;
+        
+        std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu_ids_[i]);
+        topology_[i].package_id = std::max(0, readSysfsInt(base + "/topology/physical_package_id", 0));
+        topology_[i].core_id = readSysfsInt(base + "/topology/core_id", (int)cpu_ids_[i]);
+        freq_fds_[i] = open((base + "/cpufreq/scaling_cur_freq").c_str(), O_RDONLY | O_CLOEXEC);
+    }
+    
+    prev_times_.assign(cpu_count_, CpuTimes{});
+    allocateHistory();
+    
+    // Prime the counters; utilization stays at zero until the next read
+    // gives a real delta rather than the average since boot
+    sampleLive();
+    return true;
+#else
+    return false;
+#endif
+}
+
+void CPUMonitor::initializeSynthetic(uint32_t cpu_count) {
+    closeFiles();
+    synthetic_ = true;
+    cpu_count_ = cpu_count;
+    
+    // Two packages, up to two hardware threads per core, numbered the way
+    // Linux enumerates SMT siblings: cpu N and cpu N + cores share a core.
+    // With an odd count the last core has a single thread.
+    uint32_t packages = cpu_count >= 4 ? 2 : 1;
+    uint32_t cores = std::max(1u, (cpu_count + 1) / 2);
+    uint32_t cores_per_package = (cores + packages - 1) / packages;
+    
+    cpu_ids_.resize(cpu_count);
+    index_by_id_.resize(cpu_count);
+    topology_.resize(cpu_count);
+    wave_cos_.resize(cpu_count);
+    wave_sin_.resize(cpu_count);
+    
+    // Each CPU's wave advances by a fixed angle per sample; rotating a unit
+    // vector avoids a sin() per sample when prefilling long histories
+    float step = 0.05f * (float)intervalSeconds();
+    wave_step_cos_ = std::cos(step);
+    wave_step_sin_ = std::sin(step);
+    
+    for (uint32_t i = 0; i < cpu_count; i++) {
+        uint32_t core = i % cores;
+        cpu_ids_[i] = i;
+        index_by_id_[i] = (int)i;
+        topology_[i].package_id = (int)std::min(packages - 1, core / cores_per_package);
+        topology_[i].core_id = (int)(core % cores_per_package);
+        float phase = nextRandom() * 6.2831853f;
+        wave_cos_[i] = std::cos(phase);
+        wave_sin_[i] = std::sin(phase);
+    }
+    
+    allocateHistory();
+}
+
+uint32_t CPUMonitor::update() {
+    if (!isAvailable()) {
+        return 0;
+    }
+    
+    // Catch up on missed intervals, but never stall a frame doing so
+    const uint32_t max_catch_up = 64;
+    auto now = std::chrono::steady_clock::now();
+    uint32_t taken = 0;
+    
+    while (next_sample_ <= now && taken < max_catch_up) {
+        sample();
+        next_sample_ += interval_;
+        taken++;
+    }
+    if (next_sample_ <= now) {
+        next_sample_ = now + interval_;
+    }
+    
+    return taken;
+}
+
+void CPUMonitor::sample() {
+    if (synthetic_) {
+        sampleSynthetic();
+    } else {
+        sampleLive();
+    }
+    pushSample();
+}
+
+void CPUMonitor::prefill() {
+    if (!synthetic_) {
+        return;
+    }
+    
+    // Fill one CPU's history at a time rather than one sample across all
+    // CPUs; this keeps writes sequential and is several times faster
+    std::vector<float> util_sum(history_samples_, 0.0f);
+    std::vector<float> freq_sum(history_samples_, 0.0f);
+    
+    for (uint32_t i = 0; i < cpu_count_; i++) {
+        for (size_t t = 0; t < history_samples_; t++) {
+            bool renormalize = ((synthetic_tick_ + t + 1) & 1023) == 0;
+            float util = nextSyntheticUtilization(i, renormalize);
+            current_util_[i] = util * 100.0f;
+            frequency_mhz_[i] = 1500.0f + util * 2000.0f;
+            
+            utilization_[i].push(current_util_[i]);
+            util_sum[t] += current_util_[i];
+            freq_sum[t] += frequency_mhz_[i];
+        }
+    }
+    
+    for (size_t t = 0; t < history_samples_; t++) {
+        avg_utilization_.push(util_sum[t] / (float)cpu_count_);
+        avg_frequency_.push(freq_sum[t] / (float)cpu_count_);
+    }
+    
+    synthetic_tick_ += history_samples_;
+    next_sample_ = std::chrono::steady_clock::now();
+}
+
+void CPUMonitor::sampleLive() {
+#ifdef __linux__
+    if (stat_fd_ < 0) {
+        return;
+    }
+    
+    ssize_t n = pread(stat_fd_, stat_buffer_.data(), stat_buffer_.size(), 0);
+    if (n <= 0) {
+        return;
+    }
+    
+    const char* p = stat_buffer_.data();
+    const char* end = p + n;
+    while (p < end) {
+        const char* eol = (const char*)memchr(p, '\n', (size_t)(end - p));
+        if (!eol) eol = end;
+        
+        if (eol - p > 3 && std::memcmp(p, "cpu", 3) == 0 && p[3] >= '0' && p[3] <= '9') {
+            const char* q = p + 3;
+            uint64_t id = parseU64(q, eol);
+            
+            // user nice system idle iowait irq softirq steal
+            uint64_t fields[8] = {0};
+            for (auto& field : fields) {
+                field = parseU64(q, eol);
+            }
+            
+            if (id < index_by_id_.size() && index_by_id_[id] >= 0) {
+                int index = index_by_id_[id];
+                uint64_t total = 0;
+                for (auto field : fields) total += field;
+                uint64_t busy = total - fields[3] - fields[4];
+                
+                CpuTimes& prev = prev_times_[index];
+                uint64_t d_total = total - prev.total;
+                uint64_t d_busy = busy - prev.busy;
+                if (prev.total != 0 && d_total > 0 && total >= prev.total && busy >= prev.busy) {
+                    current_util_[index] = 100.0f * (float)d_busy / (float)d_total;
+                }
+                prev.busy = busy;
+                prev.total = total;
+            }
+        } else if (std::memcmp(p, "cpu", 3) != 0) {
+            // cpu lines come first; nothing of interest after them
+            break;
+        }
+        p = eol + 1;
+    }
+    
+    for (uint32_t i = 0; i < cpu_count_; i++) {
+        if (freq_fds_[i] < 0) continue;
+        
+        char buffer[32];
+        ssize_t len = pread(freq_fds_[i], buffer, sizeof(buffer), 0);
+        if (len > 0) {
+            const char* q = buffer;
+            frequency_mhz_[i] = (float)parseU64(q, buffer + len) / 1000.0f;
+        }
+    }
+#endif
+}
+
+void CPUMonitor::sampleSynthetic() {
+    synthetic_tick_++;
+    bool renormalize = (synthetic_tick_ & 1023) == 0;
+    
+    for (uint32_t i = 0; i < cpu_count_; i++) {
+        float util = nextSyntheticUtilization(i, renormalize);
+        current_util_[i] = util * 100.0f;
+        frequency_mhz_[i] = 1500.0f + util * 2000.0f;
+    }
+}
+
+float CPUMonitor::nextSyntheticUtilization(uint32_t index, bool renormalize) {
+    // Slow per-CPU waves plus noise and occasional bursts, so both the
+    // envelope and spike-preserving paths of the plots get exercised
+    float c = wave_cos_[index];
+    float s = wave_sin_[index];
+    wave_cos_[index] = c * wave_step_cos_ - s * wave_step_sin_;
+    wave_sin_[index] = s * wave_step_cos_ + c * wave_step_sin_;
+    
+    // Renormalize now and then so rounding does not change the amplitude
+    if (renormalize) {
+        float length = std::sqrt(wave_cos_[index] * wave_cos_[index] + wave_sin_[index] * wave_sin_[index]);
+        wave_cos_[index] /= length;
+        wave_sin_[index] /= length;
+    }
+    
+    float wave = 0.5f + 0.35f * wave_sin_[index];
+    float noise = (nextRandom() - 0.5f) * 0.2f;
+    float burst = nextRandom() < 0.002f ? 0.5f : 0.0f;
+    return std::min(1.0f, std::max(0.0f, wave + noise + burst));
+}
+
+void CPUMonitor::pushSample() {
+    float util_sum = 0.0f;
+    float freq_sum = 0.0f;
+    
+    for (uint32_t i = 0; i < cpu_count_; i++) {
+        utilization_[i].push(current_util_[i]);
+        util_sum += current_util_[i];
+        freq_sum += frequency_mhz_[i];
+    }
+    
+    avg_utilization_.push(util_sum / (float)cpu_count_);
+    avg_frequency_.push(freq_sum / (float)cpu_count_);
+}
+
+float CPUMonitor::nextRandom() {
+    // xorshift64*
+    rng_state_ ^= rng_state_ >> 12;
+    rng_state_ ^= rng_state_ << 25;
+    rng_state_ ^= rng_state_ >> 27;
+    return (float)((rng_state_ * 0x2545F4914F6CDD1Dull) >> 40) / (float)(1ull << 24);
+}
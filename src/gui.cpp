@@ -8,15 +8,79 @@
 #else
 #include <GL/gl.h>
 #endif
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <cstring>
 
-GUI::GUI() : cpu_info_(std::make_unique<CPUInfo>()) {}
+// Renamed in Dear ImGui 1.89.7
+#if IMGUI_VERSION_NUM < 18970
+#define ImGuiSelectableFlags_AllowOverlap ImGuiSelectableFlags_AllowItemOverlap
+#endif
+
+namespace {
+
+// History kept for the monitor views
+constexpr int kHistorySeconds = 600;
+constexpr int kLiveIntervalMs = 100;
+constexpr int kSyntheticIntervalMs = 10;
+constexpr int kSparklineSeconds = 30;
+
+ImU32 utilizationColor(float percent) {
+    // Green -> yellow -> red
+    float t = std::min(1.0f, std::max(0.0f, percent / 100.0f));
+    float r = t < 0.5f ? t * 2.0f : 1.0f;
+    float g = t < 0.5f ? 1.0f : (1.0f - t) * 2.0f;
+    return ImGui::GetColorU32(ImVec4(r * 0.85f, g * 0.75f, 0.15f, 1.0f));
+}
+
+} // namespace
+
+GUI::GUI() : GUI(Options{}) {}
+
+GUI::GUI(const Options& options)
+    : options_(options),
+      cpu_info_(std::make_unique<CPUInfo>()),
+      ui_times_ms_(std::max<size_t>(options.benchmark_frames, 1024)),
+      frame_times_ms_(std::max<size_t>(options.benchmark_frames, 1024)) {}
 
 GUI::~GUI() {
     shutdown();
 }
 
 bool GUI::initialize() {
+    // Start the per-CPU monitor before the window so a synthetic prefill
+    // does not show up as a stalled first frame
+    if (options_.synthetic_cpus > 0) {
+        size_t samples = (size_t)kHistorySeconds * 1000 / kSyntheticIntervalMs;
+        monitor_ = std::make_unique<CPUMonitor>(samples, std::chrono::milliseconds(kSyntheticIntervalMs));
+        monitor_->initializeSynthetic(options_.synthetic_cpus);
+        printf("Generating synthetic load: %u CPUs x %zu samples\n", options_.synthetic_cpus, samples);
+        auto prefill_start = std::chrono::steady_clock::now();
+        monitor_->prefill();
+        std::chrono::duration<double> prefill_time = std::chrono::steady_clock::now() - prefill_start;
+        printf("Synthetic history ready in %.2f s\n", prefill_time.count());
+    } else {
+        size_t samples = (size_t)kHistorySeconds * 1000 / kLiveIntervalMs;
+        monitor_ = std::make_unique<CPUMonitor>(samples, std::chrono::milliseconds(kLiveIntervalMs));
+        if (!monitor_->initialize()) {
+            printf("Per-CPU monitoring not available on this platform\n");
+        }
+    }
+    
+    // Order heatmap cells by package and core so SMT siblings sit together
+    heatmap_order_.resize(monitor_->cpuCount());
+    for (uint32_t i = 0; i < monitor_->cpuCount(); i++) {
+        heatmap_order_[i] = i;
+    }
+    std::sort(heatmap_order_.begin(), heatmap_order_.end(), [this](uint32_t a, uint32_t b) {
+        const auto& ta = monitor_->topology(a);
+        const auto& tb = monitor_->topology(b);
+        if (ta.package_id != tb.package_id) return ta.package_id < tb.package_id;
+        if (ta.core_id != tb.core_id) return ta.core_id < tb.core_id;
+        return a < b;
+    });
+    
     // Initialize SDL
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) != 0) {
         printf("Error: %s\n", SDL_GetError());
@@ -46,7 +110,7 @@ bool GUI::initialize() {
 
     gl_context_ = SDL_GL_CreateContext(window_);
     SDL_GL_MakeCurrent(window_, gl_context_);
-    SDL_GL_SetSwapInterval(1); // Enable vsync
+    SDL_GL_SetSwapInterval(options_.benchmark_frames > 0 ? 0 : 1); // Enable vsync unless benchmarking
 
     // Setup Dear ImGui context
     IMGUI_CHECKVERSION();
@@ -79,6 +143,9 @@ void GUI::run() {
                 done = true;
         }
 
+        auto frame_start = std::chrono::steady_clock::now();
+        monitor_->update();
+
         // Start the Dear ImGui frame
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplSDL2_NewFrame();
@@ -88,11 +155,29 @@ void GUI::run() {
 
         // Rendering
         ImGui::Render();
+        
+        // UI time is sampling plus building the draw lists on the CPU
+        std::chrono::duration<float, std::milli> ui_time = std::chrono::steady_clock::now() - frame_start;
+        ui_times_ms_.push(ui_time.count());
+        
         glViewport(0, 0, (int)ImGui::GetIO().DisplaySize.x, (int)ImGui::GetIO().DisplaySize.y);
         glClearColor(clear_color.x, clear_color.y, clear_color.z, clear_color.w);
         glClear(GL_COLOR_BUFFER_BIT);
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
         SDL_GL_SwapWindow(window_);
+        
+        // Frame time adds draw submission and the buffer swap
+        std::chrono::duration<float, std::milli> frame_time = std::chrono::steady_clock::now() - frame_start;
+        frame_times_ms_.push(frame_time.count());
+        frame_count_++;
+        
+        if (options_.benchmark_frames > 0 && frame_count_ >= options_.benchmark_frames) {
+            done = true;
+        }
+    }
+    
+    if (options_.benchmark_frames > 0) {
+        printBenchmarkReport();
     }
 }
 
@@ -125,8 +210,20 @@ void GUI::render() {
     ImGui::Begin("x86 CPU Feature Detector", nullptr, window_flags);
     
     ImGui::Text("x86/x64 CPU Information");
+    renderFrameStats();
     ImGui::Separator();
     
+    // Benchmark mode cycles through the monitor views so each gets timed
+    const char* forced_tab = nullptr;
+    if (options_.benchmark_frames > 0) {
+        static const char* const benchmark_tabs[] = {"Per-CPU", "Topology Heatmap", "History"};
+        uint64_t phase = frame_count_ * 3 / options_.benchmark_frames;
+        forced_tab = benchmark_tabs[std::min<uint64_t>(phase, 2)];
+    }
+    auto tabFlags = [forced_tab](const char* name) {
+        return (forced_tab && std::strcmp(forced_tab, name) == 0) ? ImGuiTabItemFlags_SetSelected : ImGuiTabItemFlags_None;
+    };
+    
     if (ImGui::BeginTabBar("CPUTabs")) {
         if (ImGui::BeginTabItem("Processor Info")) {
             renderProcessorInfo();
@@ -143,6 +240,21 @@ void GUI::render() {
             ImGui::EndTabItem();
         }
         
+        if (ImGui::BeginTabItem("Per-CPU", nullptr, tabFlags("Per-CPU"))) {
+            renderPerCPU();
+            ImGui::EndTabItem();
+        }
+        
+        if (ImGui::BeginTabItem("Topology Heatmap", nullptr, tabFlags("Topology Heatmap"))) {
+            renderTopologyHeatmap();
+            ImGui::EndTabItem();
+        }
+        
+        if (ImGui::BeginTabItem("History", nullptr, tabFlags("History"))) {
+            renderHistory();
+            ImGui::EndTabItem();
+        }
+        
         ImGui::EndTabBar();
     }
     
@@ -302,3 +414,282 @@ void GUI::renderCacheInfo() {
         ImGui::Unindent();
     }
 }
+
+void GUI::renderFrameStats() {
+    if (frame_times_ms_.empty()) {
+        return;
+    }
+    
+    // Worst UI time over the last second or so
+    size_t window = std::min<size_t>(ui_times_ms_.size(), 60);
+    float worst = 0.0f;
+    for (size_t i = ui_times_ms_.size() - window; i < ui_times_ms_.size(); i++) {
+        worst = std::max(worst, ui_times_ms_[i]);
+    }
+    
+    ImGui::SameLine();
+    ImGui::TextDisabled("  |  %.1f FPS  |  UI %.2f ms (max %.2f ms)  |  frame %.2f ms  |  %u CPUs%s",
+                        ImGui::GetIO().Framerate, ui_times_ms_.latest(), worst, frame_times_ms_.latest(),
+                        monitor_->cpuCount(), monitor_->isSynthetic() ? " (synthetic)" : "");
+}
+
+void GUI::renderTimeSeries(const char* id, const RingBuffer& series, size_t window,
+                           float v_min, float v_max, float height) {
+    ImVec2 size(ImGui::GetContentRegionAvail().x, height);
+    if (size.x < 4.0f) size.x = 4.0f;
+    
+    ImVec2 p0 = ImGui::GetCursorScreenPos();
+    ImVec2 p1(p0.x + size.x, p0.y + size.y);
+    ImGui::InvisibleButton(id, size);
+    
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(p0, p1, ImGui::GetColorU32(ImGuiCol_FrameBg));
+    
+    size_t count = std::min(window, series.size());
+    if (count < 2 || !ImGui::IsItemVisible()) {
+        return;
+    }
+    size_t first = series.size() - count;
+    
+    // Window is right-aligned: the newest sample is at the right edge
+    float x_scale = size.x / (float)(window > 1 ? window - 1 : 1);
+    float x_origin = p1.x - (float)(count - 1) * x_scale;
+    float y_scale = size.y / (v_max - v_min);
+    auto toY = [&](float v) {
+        return p1.y - (std::min(v_max, std::max(v_min, v)) - v_min) * y_scale;
+    };
+    
+    ImU32 line_color = ImGui::GetColorU32(ImGuiCol_PlotLines);
+    size_t buckets = std::max<size_t>(1, (size_t)((float)(count - 1) * x_scale));
+    
+    if (plot_mode_ == PlotMode::MinMax) {
+        // One vertical span per pixel column traces the full envelope
+        Downsample::minMax(series, first, count, buckets, plot_min_, plot_max_);
+        float step = (float)(count - 1) * x_scale / (float)plot_min_.size();
+        for (size_t i = 0; i < plot_min_.size(); i++) {
+            float x = x_origin + (float)i * step;
+            float y_top = toY(plot_max_[i]);
+            float y_bottom = toY(plot_min_[i]);
+            draw_list->AddRectFilled(ImVec2(x, y_top), ImVec2(x + std::max(step, 1.0f), y_bottom + 1.0f), line_color);
+        }
+    } else {
+        Downsample::lttb(series, first, count, buckets, plot_x_, plot_y_);
+        for (size_t i = 1; i < plot_x_.size(); i++) {
+            ImVec2 a(x_origin + plot_x_[i - 1] * x_scale, toY(plot_y_[i - 1]));
+            ImVec2 b(x_origin + plot_x_[i] * x_scale, toY(plot_y_[i]));
+            draw_list->AddLine(a, b, line_color);
+        }
+    }
+    
+    if (ImGui::IsItemHovered()) {
+        float t = (ImGui::GetIO().MousePos.x - x_origin) / x_scale;
+        if (t >= 0.0f) {
+            size_t index = std::min(count - 1, (size_t)(t + 0.5f));
+            float seconds_ago = (float)(count - 1 - index) * (float)monitor_->intervalSeconds();
+            ImGui::SetTooltip("%.1f s ago: %.1f", seconds_ago, series[first + index]);
+        }
+    }
+}
+
+void GUI::renderPerCPU() {
+    ImGui::Spacing();
+    
+    if (!monitor_->isAvailable()) {
+        ImGui::Text("Per-CPU monitoring not available");
+        return;
+    }
+    
+    size_t sparkline_samples = (size_t)(kSparklineSeconds / monitor_->intervalSeconds());
+    
+    ImGuiTableFlags flags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter |
+                            ImGuiTableFlags_BordersV | ImGuiTableFlags_Resizable;
+    
+    if (!ImGui::BeginTable("PerCPU", 6, flags, ImVec2(0.0f, ImGui::GetContentRegionAvail().y))) {
+        return;
+    }
+    
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("CPU", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+    ImGui::TableSetupColumn("Package", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+    ImGui::TableSetupColumn("Core", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+    ImGui::TableSetupColumn("Utilization", ImGuiTableColumnFlags_WidthFixed, 140.0f);
+    ImGui::TableSetupColumn("Frequency", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+    ImGui::TableSetupColumn("Last 30 s", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableHeadersRow();
+    
+    // Only rows inside the scroll region are built; the clipper measures
+    // the first row itself, which includes the table's cell padding
+    const float row_height = ImGui::GetFrameHeight();
+    ImGuiListClipper clipper;
+    clipper.Begin((int)monitor_->cpuCount());
+    
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            const auto& topo = monitor_->topology(row);
+            const RingBuffer& util = monitor_->utilization(row);
+            char label[32];
+            
+            ImGui::PushID(row);
+            ImGui::TableNextRow(ImGuiTableRowFlags_None, row_height);
+            
+            ImGui::TableNextColumn();
+            snprintf(label, sizeof(label), "%u", monitor_->cpuId(row));
+            // Let the sparkline later in the row take hover for its tooltip
+            if (ImGui::Selectable(label, selected_cpu_ == row,
+                                  ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap,
+                                  ImVec2(0.0f, row_height))) {
+                selected_cpu_ = row;
+            }
+            
+            ImGui::TableNextColumn(); ImGui::Text("%d", topo.package_id);
+            ImGui::TableNextColumn(); ImGui::Text("%d", topo.core_id);
+            
+            ImGui::TableNextColumn();
+            snprintf(label, sizeof(label), "%.1f%%", util.latest());
+            ImGui::ProgressBar(util.latest() / 100.0f, ImVec2(-1.0f, 0.0f), label);
+            
+            ImGui::TableNextColumn();
+            if (monitor_->frequencyMHz(row) > 0.0f) {
+                ImGui::Text("%.0f MHz", monitor_->frequencyMHz(row));
+            } else {
+                ImGui::TextDisabled("n/a");
+            }
+            
+            ImGui::TableNextColumn();
+            renderTimeSeries("##spark", util, sparkline_samples, 0.0f, 100.0f, row_height);
+            
+            ImGui::PopID();
+        }
+    }
+    
+    ImGui::EndTable();
+}
+
+void GUI::renderTopologyHeatmap() {
+    ImGui::Spacing();
+    
+    if (!monitor_->isAvailable()) {
+        ImGui::Text("Per-CPU monitoring not available");
+        return;
+    }
+    
+    ImGui::TextDisabled("Cells are logical CPUs grouped by package and core; colour is current utilization. Click to select.");
+    ImGui::Spacing();
+    
+    const float cell = 16.0f;
+    const float gap = 2.0f;
+    const int columns = std::max(1, (int)((ImGui::GetContentRegionAvail().x + gap) / (cell + gap)));
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    ImU32 selected_color = ImGui::GetColorU32(ImGuiCol_Text);
+    
+    size_t begin = 0;
+    while (begin < heatmap_order_.size()) {
+        int package = monitor_->topology(heatmap_order_[begin]).package_id;
+        size_t end = begin;
+        while (end < heatmap_order_.size() && monitor_->topology(heatmap_order_[end]).package_id == package) {
+            end++;
+        }
+        
+        int cells = (int)(end - begin);
+        int rows = (cells + columns - 1) / columns;
+        ImGui::Text("Package %d (%d CPUs)", package, cells);
+        
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImVec2 extent((float)columns * (cell + gap), (float)rows * (cell + gap));
+        ImGui::PushID(package);
+        ImGui::InvisibleButton("##heatmap", extent);
+        bool hovered = ImGui::IsItemHovered();
+        bool clicked = ImGui::IsItemClicked();
+        ImGui::PopID();
+        
+        if (ImGui::IsItemVisible()) {
+            for (int i = 0; i < cells; i++) {
+                uint32_t cpu = heatmap_order_[begin + i];
+                ImVec2 a(origin.x + (float)(i % columns) * (cell + gap), origin.y + (float)(i / columns) * (cell + gap));
+                ImVec2 b(a.x + cell, a.y + cell);
+                draw_list->AddRectFilled(a, b, utilizationColor(monitor_->utilization(cpu).latest()));
+                if ((int)cpu == selected_cpu_) {
+                    draw_list->AddRect(a, b, selected_color, 0.0f, 0, 2.0f);
+                }
+            }
+        }
+        
+        // Hit-test arithmetically instead of submitting one item per cell
+        if (hovered) {
+            ImVec2 mouse = ImGui::GetIO().MousePos;
+            int col = (int)((mouse.x - origin.x) / (cell + gap));
+            int row = (int)((mouse.y - origin.y) / (cell + gap));
+            int i = row * columns + col;
+            if (col >= 0 && col < columns && i >= 0 && i < cells) {
+                uint32_t cpu = heatmap_order_[begin + i];
+                const auto& topo = monitor_->topology(cpu);
+                ImGui::SetTooltip("CPU %u\nPackage %d, core %d\n%.1f%% at %.0f MHz",
+                                  monitor_->cpuId(cpu), topo.package_id, topo.core_id,
+                                  monitor_->utilization(cpu).latest(), monitor_->frequencyMHz(cpu));
+                if (clicked) {
+                    selected_cpu_ = (int)cpu;
+                }
+            }
+        }
+        
+        ImGui::Spacing();
+        begin = end;
+    }
+}
+
+void GUI::renderHistory() {
+    ImGui::Spacing();
+    
+    if (!monitor_->isAvailable()) {
+        ImGui::Text("Per-CPU monitoring not available");
+        return;
+    }
+    
+    ImGui::SetNextItemWidth(200.0f);
+    ImGui::SliderInt("Window (s)", &history_seconds_, 5, kHistorySeconds);
+    ImGui::SameLine();
+    if (ImGui::RadioButton("Min/Max", plot_mode_ == PlotMode::MinMax)) plot_mode_ = PlotMode::MinMax;
+    ImGui::SameLine();
+    if (ImGui::RadioButton("LTTB", plot_mode_ == PlotMode::LTTB)) plot_mode_ = PlotMode::LTTB;
+    
+    selected_cpu_ = std::min(selected_cpu_, (int)monitor_->cpuCount() - 1);
+    size_t window = (size_t)(history_seconds_ / monitor_->intervalSeconds());
+    float plot_height = std::max(80.0f, (ImGui::GetContentRegionAvail().y - 6.0f * ImGui::GetTextLineHeightWithSpacing()) / 3.0f);
+    
+    ImGui::Spacing();
+    ImGui::Text("Average utilization, all CPUs (%%)");
+    renderTimeSeries("##avg_util", monitor_->averageUtilization(), window, 0.0f, 100.0f, plot_height);
+    
+    ImGui::Text("CPU %u utilization (%%)", monitor_->cpuId(selected_cpu_));
+    renderTimeSeries("##cpu_util", monitor_->utilization(selected_cpu_), window, 0.0f, 100.0f, plot_height);
+    
+    const auto& info = cpu_info_->getProcessorInfo();
+    float freq_max = info.max_frequency_mhz > 0 ? (float)info.max_frequency_mhz * 1.2f : 5000.0f;
+    ImGui::Text("Average frequency, all CPUs (MHz)");
+    renderTimeSeries("##avg_freq", monitor_->averageFrequency(), window, 0.0f, freq_max, plot_height);
+}
+
+void GUI::printBenchmarkReport() const {
+    printf("Benchmark: %zu frames, %u CPUs x %zu samples\n",
+           frame_times_ms_.size(), monitor_->cpuCount(), monitor_->averageUtilization().size());
+    printTimingSummary("UI (sampling + draw list construction)", ui_times_ms_);
+    printTimingSummary("Frame (UI + draw submission + swap)", frame_times_ms_);
+}
+
+void GUI::printTimingSummary(const char* label, const RingBuffer& samples) {
+    std::vector<float> times;
+    times.reserve(samples.size());
+    for (size_t i = 0; i < samples.size(); i++) {
+        times.push_back(samples[i]);
+    }
+    if (times.empty()) {
+        return;
+    }
+    std::sort(times.begin(), times.end());
+    
+    double sum = 0.0;
+    for (float t : times) sum += t;
+    
+    printf("  %s: avg %.3f ms, p50 %.3f ms, p99 %.3f ms, max %.3f ms\n", label,
+           sum / times.size(), times[times.size() / 2], times[times.size() * 99 / 100], times.back());
+}
@@ -1,11 +1,106 @@
 #include "gui.h"
+#include "metrics_exporter.h"
+#include <cerrno>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Limits keep synthetic history (CPUS x 60000 samples) within a few GB
+static const uint32_t kMaxSyntheticCpus = 4096;
+static const uint32_t kMaxBenchmarkFrames = 1000000;
+static const uint32_t kMinIntervalMs = 10;
+static const uint32_t kMaxIntervalMs = 3600 * 1000;
+
+// Parse a whole decimal number in [min, max]; rejects junk and overflow
+static bool parseCount(const char* text, uint32_t min, uint32_t max, uint32_t& value) {
+    char* end = nullptr;
+    errno = 0;
+    unsigned long parsed = std::strtoul(text, &end, 10);
+    if (errno != 0 || end == text || *end != '\0' || parsed < min || parsed > max) {
+        fprintf(stderr, "Invalid value '%s' (expected %u-%u)\n", text, min, max);
+        return false;
+    }
+    value = (uint32_t)parsed;
+    return true;
+}
+
+static void printUsage(const char* program) {
+    printf("Usage: %s [--synthetic [CPUS]] [--benchmark [FRAMES]]\n", program);
+    printf("       %s --daemon [--listen ADDR] [--interval MS]\n", program);
+    printf("  --synthetic [CPUS]    Show generated per-CPU load instead of this host (1-%u, default 512)\n",
+           kMaxSyntheticCpus);
+    printf("  --benchmark [FRAMES]  Render FRAMES frames without vsync, report frame times and exit\n");
+    printf("                        (default 1500 frames; implies --synthetic if not given)\n");
+    printf("  --daemon              Run without a window, serving Prometheus metrics\n");
+    printf("  --listen ADDR         host:port or unix:/path (default 127.0.0.1:9101)\n");
+    printf("  --interval MS         Sample interval in milliseconds (%u-%u, default 1000)\n",
+           kMinIntervalMs, kMaxIntervalMs);
+}
 
 int main(int argc, char* argv[]) {
-    (void)argc;
-    (void)argv;
+    GUI::Options options;
+    MetricsExporter::Options exporter_options;
+    bool daemon = false;
+    bool gui_flags = false;
+    bool daemon_flags = false;
+    
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc && argv[i + 1][0] != '-';
+        
+        if (std::strcmp(argv[i], "--synthetic") == 0) {
+            gui_flags = true;
+            options.synthetic_cpus = 512;
+            if (has_value && !parseCount(argv[++i], 1, kMaxSyntheticCpus, options.synthetic_cpus)) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--benchmark") == 0) {
+            gui_flags = true;
+            options.benchmark_frames = 1500;
+            if (has_value && !parseCount(argv[++i], 1, kMaxBenchmarkFrames, options.benchmark_frames)) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--daemon") == 0) {
+            daemon = true;
+        } else if (std::strcmp(argv[i], "--listen") == 0 && has_value) {
+            daemon_flags = true;
+            exporter_options.listen = argv[++i];
+        } else if (std::strcmp(argv[i], "--interval") == 0 && has_value) {
+            daemon_flags = true;
+            if (!parseCount(argv[++i], kMinIntervalMs, kMaxIntervalMs, exporter_options.interval_ms)) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else {
+            printUsage(argv[0]);
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+    
+    // Window and daemon options do not combine
+    if ((daemon && gui_flags) || (!daemon && daemon_flags)) {
+        fprintf(stderr, daemon ? "--synthetic and --benchmark cannot be used with --daemon\n"
+                               : "--listen and --interval require --daemon\n");
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    if (daemon) {
+        MetricsExporter exporter(exporter_options);
+        if (!exporter.initialize()) {
+            fprintf(stderr, "Failed to initialize metrics exporter\n");
+            return 1;
+        }
+        exporter.run();
+        return 0;
+    }
+    
+    if (options.benchmark_frames > 0 && options.synthetic_cpus == 0) {
+        options.synthetic_cpus = 512;
+    }
     
-    GUI gui;
+    GUI gui(options);
     
     if (!gui.initialize()) {
         fprintf(stderr, "Failed to initialize GUI\n");
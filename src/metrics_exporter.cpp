@@ -0,0 +1,637 @@
+#include "metrics_exporter.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <csignal>
+#include <ctime>
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+MetricsExporter::MetricsExporter(const Options& options)
+    : options_(options), cpu_info_(std::make_unique<CPUInfo>()) {}
+
+MetricsExporter::~MetricsExporter() {
+    shutdown();
+}
+
+#ifndef __linux__
+
+bool MetricsExporter::initialize() {
+    fprintf(stderr, "Daemon mode is only supported on Linux\n");
+    return false;
+}
+
+void MetricsExporter::run() {}
+void MetricsExporter::shutdown() {}
+
+#else
+
+namespace {
+
+// Longest a single client may take to send its request, and again to
+// read the reply, before it is dropped
+constexpr auto kClientBudget = std::chrono::milliseconds(200);
+
+// Concurrent connections; further ones wait in the listen backlog
+constexpr size_t kMaxClients = 64;
+
+volatile sig_atomic_t g_stop_requested = 0;
+
+void requestStop(int) {
+    g_stop_requested = 1;
+}
+
+double processCpuSeconds() {
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Scale a perf counter delta for the time it was actually on the PMU
+uint64_t scaledDelta(uint64_t delta, uint64_t enabled, uint64_t running) {
+    if (running == 0 || running >= enabled) {
+        return delta;
+    }
+    return (uint64_t)((double)delta * (double)enabled / (double)running);
+}
+
+// Appends formatted text to a fixed buffer; output past the end is dropped
+struct BufferWriter {
+    char* data;
+    size_t capacity;
+    size_t length = 0;
+    
+    void append(const char* format, ...) {
+        if (length >= capacity) return;
+        va_list args;
+        va_start(args, format);
+        int n = vsnprintf(data + length, capacity - length, format, args);
+        va_end(args);
+        if (n > 0) length = std::min(capacity, length + (size_t)n);
+    }
+};
+
+std::string escapeLabel(const std::string& value) {
+    std::string out;
+    for (char c : value) {
+        if (c == '\\' || c == '"') out += '\\';
+        if (c == '\n') {
+            out += "\\n";
+            continue;
+        }
+        out += c;
+    }
+    return out;
+}
+
+} // namespace
+
+bool MetricsExporter::initialize() {
+    if (options_.interval_ms == 0) {
+        fprintf(stderr, "Error: sample interval must be greater than zero\n");
+        return false;
+    }
+    
+    // Only the latest sample is exported; history is kept by the scraper
+    monitor_ = std::make_unique<CPUMonitor>(1, std::chrono::milliseconds(options_.interval_ms));
+    if (!monitor_->initialize()) {
+        fprintf(stderr, "Error: per-CPU monitoring not available on this platform\n");
+        return false;
+    }
+    
+    openHardwareCounters();
+    renderStaticMetrics();
+    
+    // Per-CPU series are a few hundred bytes each; size once with headroom
+    body_.assign(static_metrics_.size() + (size_t)monitor_->cpuCount() * 1024 + 8192, 0);
+    clients_.assign(kMaxClients, Client{});
+    
+    if (!openListener()) {
+        return false;
+    }
+    
+    start_time_ = std::chrono::steady_clock::now();
+    start_cpu_seconds_ = processCpuSeconds();
+    return true;
+}
+
+bool MetricsExporter::openListener() {
+    const std::string& listen = options_.listen;
+    
+    if (listen.compare(0, 5, "unix:") == 0) {
+        sockaddr_un addr{};
+        unix_path_ = listen.substr(5);
+        if (unix_path_.empty() || unix_path_.size() >= sizeof(addr.sun_path)) {
+            fprintf(stderr, "Error: invalid Unix socket path '%s'\n", unix_path_.c_str());
+            unix_path_.clear();
+            return false;
+        }
+        
+        listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+        if (listen_fd_ < 0) {
+            perror("socket");
+            return false;
+        }
+        
+        // Only replace a stale socket, never some other file at that path
+        struct stat existing;
+        if (lstat(unix_path_.c_str(), &existing) == 0) {
+            if (!S_ISSOCK(existing.st_mode)) {
+                fprintf(stderr, "Error: %s exists and is not a socket\n", unix_path_.c_str());
+                unix_path_.clear();
+                return false;
+            }
+            unlink(unix_path_.c_str());
+        }
+        
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, unix_path_.c_str(), sizeof(addr.sun_path) - 1);
+        
+        if (bind(listen_fd_, (sockaddr*)&addr, sizeof(addr)) != 0) {
+            fprintf(stderr, "Error: cannot listen on %s: %s\n", listen.c_str(), strerror(errno));
+            unix_path_.clear();
+            return false;
+        }
+        if (::listen(listen_fd_, 16) != 0) {
+            fprintf(stderr, "Error: cannot listen on %s: %s\n", listen.c_str(), strerror(errno));
+            return false;
+        }
+        return true;
+    }
+    
+    size_t colon = listen.rfind(':');
+    if (colon == std::string::npos) {
+        fprintf(stderr, "Error: listen address must be host:port or unix:/path\n");
+        return false;
+    }
+    std::string host = listen.substr(0, colon);
+    std::string port = listen.substr(colon + 1);
+    
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    
+    addrinfo* result = nullptr;
+    int rc = getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &result);
+    if (rc != 0) {
+        fprintf(stderr, "Error: cannot resolve %s: %s\n", listen.c_str(), gai_strerror(rc));
+        return false;
+    }
+    
+    for (addrinfo* ai = result; ai; ai = ai->ai_next) {
+        int fd = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC | SOCK_NONBLOCK, ai->ai_protocol);
+        if (fd < 0) continue;
+        
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        
+        if (bind(fd, ai->ai_addr, ai->ai_addrlen) == 0 && ::listen(fd, 16) == 0) {
+            listen_fd_ = fd;
+            break;
+        }
+        close(fd);
+    }
+    freeaddrinfo(result);
+    
+    if (listen_fd_ < 0) {
+        fprintf(stderr, "Error: cannot listen on %s: %s\n", listen.c_str(), strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+void MetricsExporter::openHardwareCounters() {
+    // One group per CPU (cycles leading, instructions following) so a
+    // single read() returns both values
+    counters_.assign(monitor_->cpuCount(), HardwareCounters{});
+    counters_available_ = true;
+    
+    for (uint32_t i = 0; i < monitor_->cpuCount() && counters_available_; i++) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        
+        int cpu = (int)monitor_->cpuId(i);
+        counters_[i].group_fd = (int)syscall(SYS_perf_event_open, &attr, -1, cpu, -1, PERF_FLAG_FD_CLOEXEC);
+        
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        if (counters_[i].group_fd >= 0) {
+            counters_[i].instructions_fd = (int)syscall(SYS_perf_event_open, &attr, -1, cpu,
+                                                        counters_[i].group_fd, PERF_FLAG_FD_CLOEXEC);
+        }
+        
+        if (counters_[i].group_fd < 0 || counters_[i].instructions_fd < 0) {
+            counters_available_ = false;
+        }
+    }
+    
+    if (!counters_available_) {
+        for (auto& counter : counters_) {
+            if (counter.instructions_fd >= 0) close(counter.instructions_fd);
+            if (counter.group_fd >= 0) close(counter.group_fd);
+        }
+        counters_.clear();
+        printf("Hardware counters unavailable (needs CAP_PERFMON or perf_event_paranoid <= 0)\n");
+    }
+}
+
+void MetricsExporter::renderStaticMetrics() {
+    const auto& info = cpu_info_->getProcessorInfo();
+    const auto& cache = cpu_info_->getCacheInfo();
+    const auto& features = cpu_info_->getFeatures();
+    
+    char line[512];
+    std::string& out = static_metrics_;
+    out.clear();
+    
+    out += "# HELP x86cpu_info Processor identification from CPUID.\n";
+    out += "# TYPE x86cpu_info gauge\n";
+    snprintf(line, sizeof(line), "x86cpu_info{vendor=\"%s\",brand=\"%s\",family=\"%u\",model=\"%u\",stepping=\"%u\"} 1\n",
+             escapeLabel(info.vendor).c_str(), escapeLabel(info.brand).c_str(),
+             info.family, info.model, info.stepping);
+    out += line;
+    
+    out += "# HELP x86cpu_logical_cpus Logical CPUs being monitored.\n";
+    out += "# TYPE x86cpu_logical_cpus gauge\n";
+    snprintf(line, sizeof(line), "x86cpu_logical_cpus %u\n", monitor_->cpuCount());
+    out += line;
+    
+    if (info.base_frequency_mhz > 0) {
+        out += "# HELP x86cpu_base_frequency_hertz Base frequency reported by CPUID.\n";
+        out += "# TYPE x86cpu_base_frequency_hertz gauge\n";
+        snprintf(line, sizeof(line), "x86cpu_base_frequency_hertz %u000000\n", info.base_frequency_mhz);
+        out += line;
+        out += "# HELP x86cpu_max_frequency_hertz Maximum frequency reported by CPUID.\n";
+        out += "# TYPE x86cpu_max_frequency_hertz gauge\n";
+        snprintf(line, sizeof(line), "x86cpu_max_frequency_hertz %u000000\n", info.max_frequency_mhz);
+        out += line;
+    }
+    
+    out += "# HELP x86cpu_cache_bytes Cache size per level.\n";
+    out += "# TYPE x86cpu_cache_bytes gauge\n";
+    const struct { const char* level; uint32_t kb; } caches[] = {
+        {"L1d", cache.l1_data_size}, {"L1i", cache.l1_instruction_size},
+        {"L2", cache.l2_size}, {"L3", cache.l3_size},
+    };
+    for (const auto& c : caches) {
+        if (c.kb == 0) continue;
+        snprintf(line, sizeof(line), "x86cpu_cache_bytes{level=\"%s\"} %llu\n", c.level, (unsigned long long)c.kb * 1024);
+        out += line;
+    }
+    
+    out += "# HELP x86cpu_feature Instruction set extension support (1 = supported).\n";
+    out += "# TYPE x86cpu_feature gauge\n";
+    const struct { const char* name; bool present; } flags[] = {
+        {"mmx", features.mmx}, {"sse", features.sse}, {"sse2", features.sse2}, {"sse3", features.sse3},
+        {"ssse3", features.ssse3}, {"sse4_1", features.sse4_1}, {"sse4_2", features.sse4_2},
+        {"avx", features.avx}, {"avx2", features.avx2}, {"avx512f", features.avx512f},
+        {"avx512dq", features.avx512dq}, {"avx512bw", features.avx512bw}, {"avx512vl", features.avx512vl},
+        {"fma", features.fma}, {"fma4", features.fma4}, {"aes", features.aes}, {"sha", features.sha},
+        {"pclmulqdq", features.pclmulqdq}, {"vmx", features.vmx}, {"svm", features.svm},
+        {"nx", features.nx}, {"smep", features.smep}, {"smap", features.smap}, {"sgx", features.sgx},
+        {"rdrand", features.rdrand}, {"rdseed", features.rdseed}, {"popcnt", features.popcnt},
+        {"bmi1", features.bmi1}, {"bmi2", features.bmi2}, {"tsc", features.tsc}, {"x87_fpu", features.x87_fpu},
+    };
+    for (const auto& f : flags) {
+        snprintf(line, sizeof(line), "x86cpu_feature{feature=\"%s\"} %d\n", f.name, f.present ? 1 : 0);
+        out += line;
+    }
+}
+
+void MetricsExporter::run() {
+    struct sigaction action{};
+    action.sa_handler = requestStop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+    
+    printf("Serving metrics on %s every %u ms\n", options_.listen.c_str(), options_.interval_ms);
+    fflush(stdout);
+    
+    const auto interval = std::chrono::milliseconds(options_.interval_ms);
+    // initialize() primed the counters; the first sample needs a full interval
+    auto next_sample = std::chrono::steady_clock::now() + interval;
+    
+    // Listener first, then one entry per active client
+    std::vector<pollfd> poll_fds(clients_.size() + 1);
+    std::vector<Client*> polled(clients_.size() + 1, nullptr);
+    
+    while (!g_stop_requested) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= next_sample) {
+            sample();
+            next_sample += interval;
+            if (next_sample <= now) {
+                next_sample = now + interval;
+            }
+            now = std::chrono::steady_clock::now();
+        }
+        
+        // Drop clients that ran out of time and gather the rest for poll()
+        auto wake = next_sample;
+        size_t count = 0;
+        bool slot_free = false;
+        
+        for (auto& client : clients_) {
+            if (client.state != Client::State::Free && now >= client.deadline) {
+                closeClient(client);
+            }
+            if (client.state == Client::State::Free) {
+                slot_free = true;
+                continue;
+            }
+            
+            short events = client.state == Client::State::Reading ? POLLIN : POLLOUT;
+            poll_fds[count + 1] = pollfd{client.fd, events, 0};
+            polled[count + 1] = &client;
+            wake = std::min(wake, client.deadline);
+            count++;
+        }
+        
+        // With every slot busy, new connections wait in the backlog
+        poll_fds[0] = pollfd{slot_free ? listen_fd_ : -1, POLLIN, 0};
+        
+        auto wait = std::chrono::ceil<std::chrono::milliseconds>(wake - now);
+        int ready = poll(poll_fds.data(), count + 1, (int)std::max<int64_t>(0, wait.count()));
+        if (ready <= 0) {
+            continue;
+        }
+        
+        for (size_t i = 1; i <= count; i++) {
+            Client& client = *polled[i];
+            if (poll_fds[i].revents & (POLLERR | POLLNVAL)) {
+                closeClient(client);
+            } else if (client.state == Client::State::Reading && (poll_fds[i].revents & (POLLIN | POLLHUP))) {
+                readRequest(client);
+            } else if (client.state == Client::State::Writing && (poll_fds[i].revents & (POLLOUT | POLLHUP))) {
+                writeResponse(client);
+            }
+        }
+        
+        if (poll_fds[0].revents & POLLIN) {
+            acceptClients();
+        }
+    }
+    
+    for (auto& client : clients_) {
+        closeClient(client);
+    }
+    
+    printf("Shutting down\n");
+}
+
+void MetricsExporter::shutdown() {
+    if (listen_fd_ >= 0) {
+        close(listen_fd_);
+        listen_fd_ = -1;
+    }
+    if (!unix_path_.empty()) {
+        struct stat existing;
+        if (lstat(unix_path_.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode)) {
+            unlink(unix_path_.c_str());
+        }
+        unix_path_.clear();
+    }
+    for (auto& counter : counters_) {
+        if (counter.instructions_fd >= 0) close(counter.instructions_fd);
+        if (counter.group_fd >= 0) close(counter.group_fd);
+    }
+    counters_.clear();
+    counters_available_ = false;
+}
+
+void MetricsExporter::sample() {
+    auto start = std::chrono::steady_clock::now();
+    
+    monitor_->sample();
+    
+    if (counters_available_) {
+        for (auto& counter : counters_) {
+            // nr, time_enabled, time_running, cycles, instructions
+            uint64_t values[5];
+            if (read(counter.group_fd, values, sizeof(values)) != (ssize_t)sizeof(values)) {
+                continue;
+            }
+            
+            // When the PMU is shared the group only counts part of the
+            // time; extrapolate each interval so the totals do not lag
+            uint64_t enabled = values[1] - counter.last_enabled;
+            uint64_t running = values[2] - counter.last_running;
+            if (running > 0) {
+                counter.cycles += scaledDelta(values[3] - counter.last_cycles, enabled, running);
+                counter.instructions += scaledDelta(values[4] - counter.last_instructions, enabled, running);
+            }
+            
+            counter.last_enabled = values[1];
+            counter.last_running = values[2];
+            counter.last_cycles = values[3];
+            counter.last_instructions = values[4];
+        }
+    }
+    
+    samples_++;
+    last_sample_seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void MetricsExporter::acceptClients() {
+    for (auto& client : clients_) {
+        if (client.state != Client::State::Free) continue;
+        
+        int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+        if (fd < 0) {
+            return;
+        }
+        
+        client.state = Client::State::Reading;
+        client.fd = fd;
+        client.deadline = std::chrono::steady_clock::now() + kClientBudget;
+        client.request_length = 0;
+    }
+}
+
+void MetricsExporter::readRequest(Client& client) {
+    size_t space = sizeof(client.request) - 1 - client.request_length;
+    ssize_t n = recv(client.fd, client.request + client.request_length, space, 0);
+    
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        return;
+    }
+    if (n <= 0) {
+        closeClient(client);
+        return;
+    }
+    
+    client.request_length += (size_t)n;
+    client.request[client.request_length] = '\0';
+    
+    // Only the request line matters; a full buffer is answered as-is
+    if (std::strstr(client.request, "\r\n\r\n") || client.request_length == sizeof(client.request) - 1) {
+        startResponse(client);
+    }
+}
+
+void MetricsExporter::startResponse(Client& client) {
+    const char* status = "200 OK";
+    const char* request = client.request;
+    
+    client.writing_metrics = false;
+    if (std::strncmp(request, "GET /metrics", 12) == 0 && (request[12] == ' ' || request[12] == '?')) {
+        // body_ is shared; while other clients are still writing it they
+        // and this one get the same rendering
+        scrapes_++;
+        if (metrics_writers_ == 0) {
+            body_length_ = renderMetrics();
+        }
+        metrics_writers_++;
+        client.writing_metrics = true;
+        client.body = body_.data();
+        client.body_length = body_length_;
+    } else if (std::strncmp(request, "GET / ", 6) == 0) {
+        client.body = "x86 CPU Feature Detector metrics exporter\nMetrics are at /metrics\n";
+        client.body_length = std::strlen(client.body);
+    } else {
+        status = "404 Not Found";
+        client.body = "Not found\n";
+        client.body_length = std::strlen(client.body);
+    }
+    
+    int header_length = snprintf(client.header, sizeof(client.header),
+                                 "HTTP/1.1 %s\r\n"
+                                 "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                                 "Content-Length: %zu\r\n"
+                                 "Connection: close\r\n\r\n",
+                                 status, client.body_length);
+    
+    client.header_length = (size_t)header_length;
+    client.sent = 0;
+    client.state = Client::State::Writing;
+    client.deadline = std::chrono::steady_clock::now() + kClientBudget;
+    
+    // Most replies fit in the socket buffer; try before going back to poll()
+    writeResponse(client);
+}
+
+void MetricsExporter::writeResponse(Client& client) {
+    size_t total = client.header_length + client.body_length;
+    
+    while (client.sent < total) {
+        const char* data;
+        size_t length;
+        if (client.sent < client.header_length) {
+            data = client.header + client.sent;
+            length = client.header_length - client.sent;
+        } else {
+            data = client.body + (client.sent - client.header_length);
+            length = total - client.sent;
+        }
+        
+        ssize_t n = send(client.fd, data, length, MSG_NOSIGNAL);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            return;
+        }
+        if (n <= 0) {
+            break;
+        }
+        client.sent += (size_t)n;
+    }
+    
+    closeClient(client);
+}
+
+void MetricsExporter::closeClient(Client& client) {
+    if (client.state == Client::State::Free) {
+        return;
+    }
+    if (client.writing_metrics) {
+        metrics_writers_--;
+        client.writing_metrics = false;
+    }
+    close(client.fd);
+    client.fd = -1;
+    client.state = Client::State::Free;
+}
+
+size_t MetricsExporter::renderMetrics() {
+    BufferWriter out{body_.data(), body_.size()};
+    const uint32_t cpus = monitor_->cpuCount();
+    
+    out.append("%s", static_metrics_.c_str());
+    
+    // Per-CPU series start with the first sample; until then they would
+    // read as zero rather than missing
+    if (samples_ > 0) {
+        out.append("# HELP x86cpu_core_utilization_ratio Busy fraction of each logical CPU over the last sample interval.\n");
+        out.append("# TYPE x86cpu_core_utilization_ratio gauge\n");
+        for (uint32_t i = 0; i < cpus; i++) {
+            const auto& topo = monitor_->topology(i);
+            out.append("x86cpu_core_utilization_ratio{cpu=\"%u\",package=\"%d\",core=\"%d\"} %.4f\n",
+                       monitor_->cpuId(i), topo.package_id, topo.core_id, monitor_->utilization(i).latest() / 100.0f);
+        }
+    
+        out.append("# HELP x86cpu_core_frequency_hertz Current frequency of each logical CPU from cpufreq.\n");
+        out.append("# TYPE x86cpu_core_frequency_hertz gauge\n");
+        for (uint32_t i = 0; i < cpus; i++) {
+            if (monitor_->frequencyMHz(i) <= 0.0f) continue;
+            out.append("x86cpu_core_frequency_hertz{cpu=\"%u\"} %.0f\n",
+                       monitor_->cpuId(i), (double)monitor_->frequencyMHz(i) * 1e6);
+        }
+    
+        if (counters_available_) {
+            out.append("# HELP x86cpu_core_cycles_total Core cycles counted on each logical CPU.\n");
+            out.append("# TYPE x86cpu_core_cycles_total counter\n");
+            for (uint32_t i = 0; i < cpus; i++) {
+                out.append("x86cpu_core_cycles_total{cpu=\"%u\"} %llu\n",
+                           monitor_->cpuId(i), (unsigned long long)counters_[i].cycles);
+            }
+            out.append("# HELP x86cpu_core_instructions_total Instructions retired on each logical CPU.\n");
+            out.append("# TYPE x86cpu_core_instructions_total counter\n");
+            for (uint32_t i = 0; i < cpus; i++) {
+                out.append("x86cpu_core_instructions_total{cpu=\"%u\"} %llu\n",
+                           monitor_->cpuId(i), (unsigned long long)counters_[i].instructions);
+            }
+        }
+    }
+    
+    // Self-reported cost, so the exporter's own overhead can be alerted on
+    double cpu_seconds = processCpuSeconds();
+    double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+    
+    out.append("# HELP x86cpu_exporter_cpu_seconds_total CPU time charged to the exporter process; excludes kernel work on other CPUs, such as IPIs for perf counter reads.\n");
+    out.append("# TYPE x86cpu_exporter_cpu_seconds_total counter\n");
+    out.append("x86cpu_exporter_cpu_seconds_total %.6f\n", cpu_seconds);
+    double serving_seconds = cpu_seconds - start_cpu_seconds_;
+    
+    out.append("# HELP x86cpu_exporter_overhead_ratio Exporter process CPU time since startup, as a fraction of one core; excludes kernel work on other CPUs, such as IPIs for perf counter reads.\n");
+    out.append("# TYPE x86cpu_exporter_overhead_ratio gauge\n");
+    out.append("x86cpu_exporter_overhead_ratio %.8f\n", wall_seconds > 0.0 ? serving_seconds / wall_seconds : 0.0);
+    out.append("# HELP x86cpu_exporter_last_sample_duration_seconds Wall time of the most recent sample.\n");
+    out.append("# TYPE x86cpu_exporter_last_sample_duration_seconds gauge\n");
+    out.append("x86cpu_exporter_last_sample_duration_seconds %.9f\n", last_sample_seconds_);
+    out.append("# HELP x86cpu_exporter_samples_total Samples taken since startup.\n");
+    out.append("# TYPE x86cpu_exporter_samples_total counter\n");
+    out.append("x86cpu_exporter_samples_total %llu\n", (unsigned long long)samples_);
+    out.append("# HELP x86cpu_exporter_scrapes_total Metric scrapes served since startup.\n");
+    out.append("# TYPE x86cpu_exporter_scrapes_total counter\n");
+    out.append("x86cpu_exporter_scrapes_total %llu\n", (unsigned long long)scrapes_);
+    
+    return out.length;
+}
+
+#endif
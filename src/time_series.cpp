@@ -0,0 +1,141 @@
+#include "time_series.h"
+#include <algorithm>
+#include <cmath>
+
+void RingBuffer::reset(size_t capacity) {
+    data_.assign(capacity > 0 ? capacity : 1, 0.0f);
+    head_ = 0;
+    size_ = 0;
+}
+
+void RingBuffer::spans(size_t first, size_t count,
+                       const float*& a, size_t& a_len, const float*& b, size_t& b_len) const {
+    a = b = data_.data();
+    a_len = b_len = 0;
+    
+    if (first >= size_) return;
+    count = std::min(count, size_ - first);
+    
+    size_t start = head_ + data_.size() - size_ + first;
+    if (start >= data_.size()) start -= data_.size();
+    
+    a = data_.data() + start;
+    a_len = std::min(count, data_.size() - start);
+    b_len = count - a_len;
+}
+
+namespace Downsample {
+
+void minMax(const RingBuffer& src, size_t first, size_t count, size_t buckets,
+            std::vector<float>& out_min, std::vector<float>& out_max) {
+    out_min.clear();
+    out_max.clear();
+    
+    if (first >= src.size() || buckets == 0) return;
+    count = std::min(count, src.size() - first);
+    if (count == 0) return;
+    
+    const float* a;
+    const float* b;
+    size_t a_len, b_len;
+    src.spans(first, count, a, a_len, b, b_len);
+    
+    // Fewer samples than buckets: emit them as-is
+    if (count <= buckets) {
+        for (size_t i = 0; i < count; i++) {
+            float v = i < a_len ? a[i] : b[i - a_len];
+            out_min.push_back(v);
+            out_max.push_back(v);
+        }
+        return;
+    }
+    
+    // Walk both spans once; bucket boundaries are computed in integer
+    // arithmetic so every sample lands in exactly one bucket
+    size_t i = 0;
+    for (size_t bucket = 0; bucket < buckets; bucket++) {
+        size_t end = (bucket + 1) * count / buckets;
+        float lo = INFINITY;
+        float hi = -INFINITY;
+        
+        for (; i < end && i < a_len; i++) {
+            lo = std::min(lo, a[i]);
+            hi = std::max(hi, a[i]);
+        }
+        for (; i < end; i++) {
+            float v = b[i - a_len];
+            lo = std::min(lo, v);
+            hi = std::max(hi, v);
+        }
+        
+        out_min.push_back(lo);
+        out_max.push_back(hi);
+    }
+}
+
+void lttb(const RingBuffer& src, size_t first, size_t count, size_t threshold,
+          std::vector<float>& out_x, std::vector<float>& out_y) {
+    out_x.clear();
+    out_y.clear();
+    
+    if (first >= src.size()) return;
+    count = std::min(count, src.size() - first);
+    
+    auto at = [&](size_t i) { return src[first + i]; };
+    
+    if (threshold >= count || threshold < 3) {
+        for (size_t i = 0; i < count; i++) {
+            out_x.push_back((float)i);
+            out_y.push_back(at(i));
+        }
+        return;
+    }
+    
+    // First point is always kept
+    out_x.push_back(0.0f);
+    out_y.push_back(at(0));
+    
+    const double every = (double)(count - 2) / (double)(threshold - 2);
+    size_t a = 0;
+    
+    for (size_t bucket = 0; bucket < threshold - 2; bucket++) {
+        // Average of the next bucket acts as the third triangle vertex
+        size_t next_start = (size_t)((bucket + 1) * every) + 1;
+        size_t next_end = std::min((size_t)((bucket + 2) * every) + 1, count);
+        double avg_x = 0.0;
+        double avg_y = 0.0;
+        for (size_t j = next_start; j < next_end; j++) {
+            avg_x += (double)j;
+            avg_y += at(j);
+        }
+        size_t next_len = next_end > next_start ? next_end - next_start : 1;
+        avg_x /= (double)next_len;
+        avg_y /= (double)next_len;
+        
+        // Pick the point in this bucket forming the largest triangle
+        size_t start = (size_t)(bucket * every) + 1;
+        size_t end = (size_t)((bucket + 1) * every) + 1;
+        double ax = (double)a;
+        double ay = at(a);
+        double best_area = -1.0;
+        size_t best = start;
+        
+        for (size_t j = start; j < end; j++) {
+            double area = std::fabs((ax - avg_x) * (at(j) - ay) - (ax - (double)j) * (avg_y - ay));
+            if (area > best_area) {
+                best_area = area;
+                best = j;
+            }
+        }
+        
+        out_x.push_back((float)best);
+        out_y.push_back(at(best));
+        a = best;
+    }
+    
+    // Last point is always kept
+    out_x.push_back((float)(count - 1));
+    out_y.push_back(at(count - 1));
+}
+
+} // namespace Downsample